@@ -1,243 +1,329 @@
 #define _USE_MATH_DEFINES
 #include <cmath>
-#include <map>
-#include <stack>
-#include <sstream>
-#include <algorithm>
-#include <cctype>
+#include <string>
+#include <string_view>
+#include <charconv>
 #include <stdexcept>
 #include <vector>
 #include <cstddef>
-#include <tuple>
 #include <functional>
+#include <utility>
+#include "analisador_funcao.h"
 
 using namespace std;
 
-const int TIPO_TOKEN_NUMERO = 0;
-const int TIPO_TOKEN_VARIAVEL = 1;
-const int TIPO_TOKEN_OPERADOR = 2;
-const int TIPO_TOKEN_FUNCAO = 3;
-const int TIPO_TOKEN_PARENTESE_ABRE = 4;
-const int TIPO_TOKEN_PARENTESE_FECHA = 5;
+struct NomeFuncao {
+    string_view nome;
+    int codigo;
+};
 
-// tipo, valor, precedencia, associativo_direita
-using Token = tuple<int, string, int, bool>;
+const NomeFuncao TABELA_FUNCOES[] = {
+    {"sin", FUNCAO_SEN}, {"sen", FUNCAO_SEN},
+    {"cos", FUNCAO_COS},
+    {"tan", FUNCAO_TAN}, {"tg", FUNCAO_TAN},
+    {"cosec", FUNCAO_COSEC},
+    {"sec", FUNCAO_SEC},
+    {"cotg", FUNCAO_COTG}, {"cot", FUNCAO_COTG},
+    {"sinh", FUNCAO_SENH},
+    {"cosh", FUNCAO_COSH},
+    {"tanh", FUNCAO_TANH},
+    {"exp", FUNCAO_EXP},
+    {"log", FUNCAO_LOG}, {"ln", FUNCAO_LOG},
+    {"log10", FUNCAO_LOG10},
+    {"sqrt", FUNCAO_RAIZ}, {"raiz", FUNCAO_RAIZ},
+    {"abs", FUNCAO_ABS},
+};
 
-vector<Token> tokenizar(const string& expressao);
-vector<Token> shunting_yard(const vector<Token>& tokens_infix);
-double avaliar_rpn(const vector<Token>& tokens_rpn, double valor_x);
-string pre_processar_string_funcao_para_analise(const string& str_funcao);
-function<double(double)> analisar_string_funcao(const string& str_funcao);
+ArenaAnalisador& obter_arena_analisador() {
+    thread_local ArenaAnalisador arena;
+    return arena;
+}
 
-int obter_precedencia(const string& operador);
-double aplicar_operador(double operando1, double operando2, const string& operador);
-double aplicar_funcao_nomeada(const string& nome_funcao, double valor_arg);
+int obter_precedencia(char operador) {
+    if (operador == '+' || operador == '-') return 1;
+    if (operador == '*' || operador == '/') return 2;
+    if (operador == '^') return 3; 
+    return 0;
+}
 
+int obter_codigo_funcao(string_view nome_funcao) {
+    for (const auto& entrada : TABELA_FUNCOES) {
+        if (entrada.nome == nome_funcao) return entrada.codigo;
+    }
+    return FUNCAO_DESCONHECIDA;
+}
 
-int obter_precedencia(const string& operador) {
-    if (operador == "+" || operador == "-") return 1;
-    if (operador == "*" || operador == "/") return 2;
-    if (operador == "^") return 3; 
-    return 0;
+const char* obter_nome_funcao(int codigo_funcao) {
+    for (const auto& entrada : TABELA_FUNCOES) {
+        if (entrada.codigo == codigo_funcao) return entrada.nome.data();
+    }
+    return "?";
 }
 
-double aplicar_operador(double operando1, double operando2, const string& operador) {
-    if (operador == "+") return operando1 + operando2;
-    if (operador == "-") return operando1 - operando2;
-    if (operador == "*") return operando1 * operando2;
-    if (operador == "/") {
-        if (abs(operando2) < 1e-12) {
-            throw runtime_error("Erro: Divisão por zero ou valor muito próximo de zero.");
-        }
-        return operando1 / operando2;
+double aplicar_operador(double operando1, double operando2, char operador) {
+    switch (operador) {
+        case '+': return operando1 + operando2;
+        case '-': return operando1 - operando2;
+        case '*': return operando1 * operando2;
+        case '/':
+            if (abs(operando2) < 1e-12) {
+                throw runtime_error("Erro: Divisão por zero ou valor muito próximo de zero.");
+            }
+            return operando1 / operando2;
+        case '^': return pow(operando1, operando2);
     }
-    if (operador == "^") return pow(operando1, operando2);
-    throw runtime_error("Operador desconhecido: " + operador);
-}
-
-double aplicar_funcao_nomeada(const string& nome_funcao, double valor_arg) {
-    if (nome_funcao == "sin" || nome_funcao == "sen") return sin(valor_arg);
-    if (nome_funcao == "cos") return cos(valor_arg);
-    if (nome_funcao == "tan" || nome_funcao == "tg") return tan(valor_arg);
-    if (nome_funcao == "cosec") return 1.0 / sin(valor_arg);
-    if (nome_funcao == "sec") return 1.0 / cos(valor_arg);
-    if (nome_funcao == "cotg" || nome_funcao == "cot") return 1.0 / tan(valor_arg);
-    if (nome_funcao == "sinh") return sinh(valor_arg);
-    if (nome_funcao == "cosh") return cosh(valor_arg);
-    if (nome_funcao == "tanh") return tanh(valor_arg);
-    if (nome_funcao == "exp") return exp(valor_arg);
-    if (nome_funcao == "log" || nome_funcao == "ln") return log(valor_arg);
-    if (nome_funcao == "log10") return log10(valor_arg);
-    if (nome_funcao == "sqrt" || nome_funcao == "raiz") return sqrt(valor_arg);
-    if (nome_funcao == "abs") return abs(valor_arg);
-    throw runtime_error("Função matemática desconhecida: " + nome_funcao);
-}
-
-vector<Token> tokenizar(const string& expressao) {
-    vector<Token> tokens;
+    throw runtime_error("Operador desconhecido: " + string(1, operador));
+}
+
+double aplicar_funcao_nomeada(int codigo_funcao, double valor_arg) {
+    switch (codigo_funcao) {
+        case FUNCAO_SEN: return sin(valor_arg);
+        case FUNCAO_COS: return cos(valor_arg);
+        case FUNCAO_TAN: return tan(valor_arg);
+        case FUNCAO_COSEC: return 1.0 / sin(valor_arg);
+        case FUNCAO_SEC: return 1.0 / cos(valor_arg);
+        case FUNCAO_COTG: return 1.0 / tan(valor_arg);
+        case FUNCAO_SENH: return sinh(valor_arg);
+        case FUNCAO_COSH: return cosh(valor_arg);
+        case FUNCAO_TANH: return tanh(valor_arg);
+        case FUNCAO_EXP: return exp(valor_arg);
+        case FUNCAO_LOG: return log(valor_arg);
+        case FUNCAO_LOG10: return log10(valor_arg);
+        case FUNCAO_RAIZ: return sqrt(valor_arg);
+        case FUNCAO_ABS: return abs(valor_arg);
+    }
+    throw runtime_error("Função matemática desconhecida (codigo " + to_string(codigo_funcao) + ")");
+}
+
+void tokenizar(string_view expressao, vector<Token>& tokens) {
+    tokens.clear();
     for (size_t i = 0; i < expressao.length(); ++i) {
-        if (isspace(expressao[i])) continue;
-        if (isdigit(expressao[i]) || (expressao[i] == '.' && i + 1 < expressao.length() && isdigit(expressao[i+1]))) {
-            string str_num;
-            while (i < expressao.length() && (isdigit(expressao[i]) || expressao[i] == '.')) {
-                str_num += expressao[i];
+        if (isspace(static_cast<unsigned char>(expressao[i]))) continue;
+        if (isdigit(static_cast<unsigned char>(expressao[i])) || (expressao[i] == '.' && i + 1 < expressao.length() && isdigit(static_cast<unsigned char>(expressao[i+1])))) {
+            size_t inicio = i;
+            while (i < expressao.length() && (isdigit(static_cast<unsigned char>(expressao[i])) || expressao[i] == '.')) {
                 i++;
             }
+            double valor = 0.0;
+            from_chars_result resultado = from_chars(expressao.data() + inicio, expressao.data() + i, valor);
+            if (resultado.ec != errc() || resultado.ptr != expressao.data() + i) {
+                throw runtime_error("Número inválido na expressao: " + string(expressao.substr(inicio, i - inicio)));
+            }
             --i; 
-            tokens.push_back(make_tuple(TIPO_TOKEN_NUMERO, str_num, 0, false));
+            tokens.push_back({TIPO_TOKEN_NUMERO, 0, valor, 0, false});
         } 
         else if (expressao[i] == 'x') {
-            tokens.push_back(make_tuple(TIPO_TOKEN_VARIAVEL, "x", 0, false));
+            tokens.push_back({TIPO_TOKEN_VARIAVEL, 0, 0.0, 0, false});
         } 
-        else if (expressao[i] == 'e' && (i + 1 >= expressao.length() || !isalpha(expressao[i+1]))) {
-            tokens.push_back(make_tuple(TIPO_TOKEN_NUMERO, to_string(M_E), 0, false));
+        else if (expressao[i] == 'e' && (i + 1 >= expressao.length() || !isalpha(static_cast<unsigned char>(expressao[i+1])))) {
+            tokens.push_back({TIPO_TOKEN_NUMERO, 0, M_E, 0, false});
         } 
         else if (expressao.substr(i, 2) == "pi") {
-            tokens.push_back(make_tuple(TIPO_TOKEN_NUMERO, to_string(M_PI), 0, false));
+            tokens.push_back({TIPO_TOKEN_NUMERO, 0, M_PI, 0, false});
             i++; 
         } 
         else if (expressao[i] == '(') {
-            tokens.push_back(make_tuple(TIPO_TOKEN_PARENTESE_ABRE, "(", 0, false));
+            tokens.push_back({TIPO_TOKEN_PARENTESE_ABRE, '(', 0.0, 0, false});
         } 
         else if (expressao[i] == ')') {
-            tokens.push_back(make_tuple(TIPO_TOKEN_PARENTESE_FECHA, ")", 0, false));
+            tokens.push_back({TIPO_TOKEN_PARENTESE_FECHA, ')', 0.0, 0, false});
         } 
         else if (expressao[i] == '*' || expressao[i] == '/' || expressao[i] == '^') {
-            string str_op(1, expressao[i]);
-            tokens.push_back(make_tuple(TIPO_TOKEN_OPERADOR, str_op, obter_precedencia(str_op), (str_op == "^")));
+            char operador = expressao[i];
+            tokens.push_back({TIPO_TOKEN_OPERADOR, operador, 0.0, obter_precedencia(operador), (operador == '^')});
         } 
         else if (expressao[i] == '-' || expressao[i] == '+') {
-            bool eh_unario = (tokens.empty() || get<0>(tokens.back()) == TIPO_TOKEN_OPERADOR || get<0>(tokens.back()) == TIPO_TOKEN_PARENTESE_ABRE);
+            bool eh_unario = (tokens.empty() || tokens.back().tipo == TIPO_TOKEN_OPERADOR || tokens.back().tipo == TIPO_TOKEN_PARENTESE_ABRE);
             if (eh_unario) {
-                tokens.push_back(make_tuple(TIPO_TOKEN_NUMERO, "0", 0, false));
+                tokens.push_back({TIPO_TOKEN_NUMERO, 0, 0.0, 0, false});
             }
-            string str_op(1, expressao[i]);
-            tokens.push_back(make_tuple(TIPO_TOKEN_OPERADOR, str_op, obter_precedencia(str_op), false));
+            char operador = expressao[i];
+            tokens.push_back({TIPO_TOKEN_OPERADOR, operador, 0.0, obter_precedencia(operador), false});
         } 
-        else if (isalpha(expressao[i])) {
-            string nome;
-            while (i < expressao.length() && isalpha(expressao[i])) {
-                nome += expressao[i];
+        else if (isalpha(static_cast<unsigned char>(expressao[i]))) {
+            size_t inicio = i;
+            while (i < expressao.length() && isalpha(static_cast<unsigned char>(expressao[i]))) {
                 i++;
             }
+            string_view nome = expressao.substr(inicio, i - inicio);
             --i; 
-            tokens.push_back(make_tuple(TIPO_TOKEN_FUNCAO, nome, 0, false));
+            int codigo = obter_codigo_funcao(nome);
+            if (codigo == FUNCAO_DESCONHECIDA) {
+                throw runtime_error("Função matemática desconhecida: " + string(nome));
+            }
+            tokens.push_back({TIPO_TOKEN_FUNCAO, codigo, 0.0, 0, false});
         } 
         else {
             throw runtime_error("Caractere inesperado na expressao: " + string(1, expressao[i]));
         }
     }
-    return tokens;
 }
 
-vector<Token> shunting_yard(const vector<Token>& tokens_infix) {
-    vector<Token> fila_saida;
-    stack<Token> pilha_operadores;
+void shunting_yard(const vector<Token>& tokens_infix, vector<Token>& fila_saida, vector<Token>& pilha_operadores) {
+    fila_saida.clear();
+    pilha_operadores.clear();
     for (const auto& token : tokens_infix) {
-        int tipo_token = get<0>(token);
+        int tipo_token = token.tipo;
         if (tipo_token == TIPO_TOKEN_NUMERO || tipo_token == TIPO_TOKEN_VARIAVEL) {
             fila_saida.push_back(token);
         } 
         else if (tipo_token == TIPO_TOKEN_FUNCAO) {
-            pilha_operadores.push(token);
+            pilha_operadores.push_back(token);
         } 
         else if (tipo_token == TIPO_TOKEN_OPERADOR) {
-            int precedencia_atual = get<2>(token);
-            bool associativo_direita = get<3>(token);
+            int precedencia_atual = token.precedencia;
+            bool associativo_direita = token.associativo_direita;
             while (!pilha_operadores.empty() && 
-                   get<0>(pilha_operadores.top()) != TIPO_TOKEN_PARENTESE_ABRE &&
-                   (get<2>(pilha_operadores.top()) > precedencia_atual || 
-                    (get<2>(pilha_operadores.top()) == precedencia_atual && !associativo_direita))) {
-                fila_saida.push_back(pilha_operadores.top());
-                pilha_operadores.pop();
+                   pilha_operadores.back().tipo != TIPO_TOKEN_PARENTESE_ABRE &&
+                   (pilha_operadores.back().precedencia > precedencia_atual || 
+                    (pilha_operadores.back().precedencia == precedencia_atual && !associativo_direita))) {
+                fila_saida.push_back(pilha_operadores.back());
+                pilha_operadores.pop_back();
             }
-            pilha_operadores.push(token);
+            pilha_operadores.push_back(token);
         } 
         else if (tipo_token == TIPO_TOKEN_PARENTESE_ABRE) {
-            pilha_operadores.push(token);
+            pilha_operadores.push_back(token);
         } 
         else if (tipo_token == TIPO_TOKEN_PARENTESE_FECHA) {
-            while (!pilha_operadores.empty() && get<0>(pilha_operadores.top()) != TIPO_TOKEN_PARENTESE_ABRE) {
-                fila_saida.push_back(pilha_operadores.top());
-                pilha_operadores.pop();
+            while (!pilha_operadores.empty() && pilha_operadores.back().tipo != TIPO_TOKEN_PARENTESE_ABRE) {
+                fila_saida.push_back(pilha_operadores.back());
+                pilha_operadores.pop_back();
             }
-            if (pilha_operadores.empty() || get<0>(pilha_operadores.top()) != TIPO_TOKEN_PARENTESE_ABRE) {
+            if (pilha_operadores.empty() || pilha_operadores.back().tipo != TIPO_TOKEN_PARENTESE_ABRE) {
                 throw runtime_error("Erro: Parênteses desbalanceados.");
             }
-            pilha_operadores.pop(); 
-            if (!pilha_operadores.empty() && get<0>(pilha_operadores.top()) == TIPO_TOKEN_FUNCAO) {
-                fila_saida.push_back(pilha_operadores.top());
-                pilha_operadores.pop();
+            pilha_operadores.pop_back(); 
+            if (!pilha_operadores.empty() && pilha_operadores.back().tipo == TIPO_TOKEN_FUNCAO) {
+                fila_saida.push_back(pilha_operadores.back());
+                pilha_operadores.pop_back();
             }
         }
     }
     while (!pilha_operadores.empty()) {
-        if (get<0>(pilha_operadores.top()) == TIPO_TOKEN_PARENTESE_ABRE || 
-            get<0>(pilha_operadores.top()) == TIPO_TOKEN_PARENTESE_FECHA) {
+        if (pilha_operadores.back().tipo == TIPO_TOKEN_PARENTESE_ABRE || 
+            pilha_operadores.back().tipo == TIPO_TOKEN_PARENTESE_FECHA) {
             throw runtime_error("Erro: Parênteses desbalanceados.");
         }
-        fila_saida.push_back(pilha_operadores.top());
-        pilha_operadores.pop();
+        fila_saida.push_back(pilha_operadores.back());
+        pilha_operadores.pop_back();
     }
-    return fila_saida;
 }
 
-double avaliar_rpn(const vector<Token>& tokens_rpn, double valor_x) {
-    stack<double> pilha_operandos;
-    for (const auto& token : tokens_rpn) {
-        int tipo_token = get<0>(token);
-        string valor_token = get<1>(token);
+double avaliar_rpn(const Token* tokens_rpn, size_t quantidade, double valor_x, vector<double>& pilha_operandos) {
+    pilha_operandos.clear();
+    for (size_t i = 0; i < quantidade; ++i) {
+        const Token& token = tokens_rpn[i];
+        int tipo_token = token.tipo;
         if (tipo_token == TIPO_TOKEN_NUMERO) {
-            pilha_operandos.push(stod(valor_token));
+            pilha_operandos.push_back(token.valor);
         } 
         else if (tipo_token == TIPO_TOKEN_VARIAVEL) {
-            pilha_operandos.push(valor_x);
+            pilha_operandos.push_back(valor_x);
         } 
         else if (tipo_token == TIPO_TOKEN_OPERADOR) {
             if (pilha_operandos.size() < 2) {
-                throw runtime_error("Erro de sintaxe: operador '" + valor_token + "' sem operandos suficientes.");
+                throw runtime_error("Erro de sintaxe: operador '" + string(1, static_cast<char>(token.codigo)) + "' sem operandos suficientes.");
             }
-            double operando2 = pilha_operandos.top(); pilha_operandos.pop();
-            double operando1 = pilha_operandos.top(); pilha_operandos.pop();
-            pilha_operandos.push(aplicar_operador(operando1, operando2, valor_token));
+            double operando2 = pilha_operandos.back(); pilha_operandos.pop_back();
+            double operando1 = pilha_operandos.back(); pilha_operandos.pop_back();
+            pilha_operandos.push_back(aplicar_operador(operando1, operando2, static_cast<char>(token.codigo)));
         } 
         else if (tipo_token == TIPO_TOKEN_FUNCAO) {
             if (pilha_operandos.empty()) {
-                throw runtime_error("Erro de sintaxe: função '" + valor_token + "' sem argumento.");
+                throw runtime_error("Erro de sintaxe: função '" + string(obter_nome_funcao(token.codigo)) + "' sem argumento.");
             }
-            double arg = pilha_operandos.top(); pilha_operandos.pop();
-            pilha_operandos.push(aplicar_funcao_nomeada(valor_token, arg));
+            double arg = pilha_operandos.back(); pilha_operandos.pop_back();
+            pilha_operandos.push_back(aplicar_funcao_nomeada(token.codigo, arg));
         }
     }
     if (pilha_operandos.size() != 1) {
         throw runtime_error("Erro de sintaxe: expressão inválida ou incompleta.");
     }
-    return pilha_operandos.top();
+    return pilha_operandos.back();
+}
+
+double avaliar_rpn(const vector<Token>& tokens_rpn, double valor_x, vector<double>& pilha_operandos) {
+    return avaliar_rpn(tokens_rpn.data(), tokens_rpn.size(), valor_x, pilha_operandos);
+}
+
+double avaliar_rpn(const vector<Token>& tokens_rpn, double valor_x) {
+    return avaliar_rpn(tokens_rpn, valor_x, obter_arena_analisador().pilha_operandos);
+}
+
+string_view pre_processar_string_funcao_para_analise(string_view str_funcao) {
+    size_t pos_igual = str_funcao.find('=');
+    if (pos_igual != string_view::npos) {
+        str_funcao.remove_prefix(pos_igual + 1);
+    }
+    size_t inicio = str_funcao.find_first_not_of(" \t\n\r\f\v");
+    if (inicio == string_view::npos) return string_view();
+    size_t fim = str_funcao.find_last_not_of(" \t\n\r\f\v");
+    return str_funcao.substr(inicio, fim - inicio + 1);
+}
+
+// Tokeniza e converte para RPN em arena.fila_saida, sem guardar nada em arena.programas.
+void converter_para_rpn(string_view str_pre_processada, ArenaAnalisador& arena) {
+    tokenizar(str_pre_processada, arena.tokens);
+    shunting_yard(arena.tokens, arena.fila_saida, arena.pilha_operadores);
+}
+
+// Compila a expressao acrescentando sua RPN em arena.programas e seu texto em arena.textos.
+ProgramaRpn compilar_expressao(string_view str_funcao, ArenaAnalisador& arena) {
+    string_view str_pre_processada = pre_processar_string_funcao_para_analise(str_funcao);
+    converter_para_rpn(str_pre_processada, arena);
+    ProgramaRpn programa = {arena.programas.size(), arena.fila_saida.size(), arena.textos.size(), str_pre_processada.size()};
+    arena.programas.insert(arena.programas.end(), arena.fila_saida.begin(), arena.fila_saida.end());
+    arena.textos.append(str_pre_processada);
+    return programa;
 }
 
-string pre_processar_string_funcao_para_analise(const string& str_funcao) {
-    string str_processada = str_funcao;
-    size_t pos_igual = str_processada.find("=");
-    if (pos_igual != string::npos) {
-        str_processada = str_processada.substr(pos_igual + 1);
+// A pilha de operandos usada e a da thread chamadora, entao varias threads podem avaliar
+// programas da mesma arena enquanto ninguem compila nela.
+double avaliar_programa(const ArenaAnalisador& arena, ProgramaRpn programa, double valor_x) {
+    return avaliar_rpn(arena.programas.data() + programa.inicio, programa.tamanho, valor_x, obter_arena_analisador().pilha_operandos);
+}
+
+// A funcao devolvida so guarda a arena e o indice do programa, cabendo no armazenamento interno
+// de std::function; vale ate o proximo limpar_programas da arena.
+function<double(double)> compilar_funcao(string_view str_funcao, ArenaAnalisador& arena) {
+    ProgramaRpn programa;
+    try {
+        programa = compilar_expressao(str_funcao, arena);
+    } catch (const exception& e) {
+        throw runtime_error("Erro ao avaliar função '" + string(pre_processar_string_funcao_para_analise(str_funcao)) + "': " + e.what());
     }
-    size_t pos_e_exp = str_processada.find("e^");
-    while (pos_e_exp != string::npos) {
-        if (pos_e_exp == 0 || !isalpha(str_processada[pos_e_exp-1])) {
-            str_processada.replace(pos_e_exp, 2, "exp");
+    size_t indice = arena.compilados.size();
+    arena.compilados.push_back(programa);
+    return [arena = &arena, indice](double valor_x) {
+        const ProgramaRpn& programa = arena->compilados[indice];
+        try {
+            return avaliar_programa(*arena, programa, valor_x);
+        } catch (const exception& e) {
+            throw runtime_error("Erro ao avaliar função '" + arena->textos.substr(programa.inicio_texto, programa.tamanho_texto) + "': " + e.what());
         }
-        pos_e_exp = str_processada.find("e^", pos_e_exp + 1);
-    }
-    str_processada.erase(remove(str_processada.begin(), str_processada.end(), ' '), str_processada.end());
-    return str_processada;
+    };
+}
+
+void limpar_programas(ArenaAnalisador& arena) {
+    arena.programas.clear();
+    arena.textos.clear();
+    arena.compilados.clear();
 }
 
+// Compila uma vez e devolve uma funcao dona da sua propria copia da RPN (algumas alocacoes por
+// expressao), independente de qualquer arena.
 function<double(double)> analisar_string_funcao(const string& str_funcao) {
-    string str_pre_processada = pre_processar_string_funcao_para_analise(str_funcao);
-    return [str_pre_processada](double valor_x) {
+    string str_pre_processada(pre_processar_string_funcao_para_analise(str_funcao));
+    ArenaAnalisador& arena = obter_arena_analisador();
+    try {
+        converter_para_rpn(str_pre_processada, arena);
+    } catch (const exception& e) {
+        throw runtime_error("Erro ao avaliar função '" + str_pre_processada + "': " + e.what());
+    }
+    vector<Token> tokens_rpn(arena.fila_saida);
+    return [str_pre_processada = move(str_pre_processada), tokens_rpn = move(tokens_rpn)](double valor_x) {
         try {
-            vector<Token> tokens = tokenizar(str_pre_processada);
-            vector<Token> tokens_rpn = shunting_yard(tokens);
             return avaliar_rpn(tokens_rpn, valor_x);
         } catch (const exception& e) {
             throw runtime_error("Erro ao avaliar função '" + str_pre_processada + "': " + e.what());
@@ -0,0 +1,84 @@
+#ifndef ANALISADOR_FUNCAO_H
+#define ANALISADOR_FUNCAO_H
+
+#include <string>
+#include <string_view>
+#include <vector>
+#include <cstddef>
+#include <functional>
+
+const int TIPO_TOKEN_NUMERO = 0;
+const int TIPO_TOKEN_VARIAVEL = 1;
+const int TIPO_TOKEN_OPERADOR = 2;
+const int TIPO_TOKEN_FUNCAO = 3;
+const int TIPO_TOKEN_PARENTESE_ABRE = 4;
+const int TIPO_TOKEN_PARENTESE_FECHA = 5;
+
+// Codigos internos das funcoes nomeadas; sinonimos (sen/sin, ln/log, ...) compartilham o mesmo codigo.
+const int FUNCAO_SEN = 0;
+const int FUNCAO_COS = 1;
+const int FUNCAO_TAN = 2;
+const int FUNCAO_COSEC = 3;
+const int FUNCAO_SEC = 4;
+const int FUNCAO_COTG = 5;
+const int FUNCAO_SENH = 6;
+const int FUNCAO_COSH = 7;
+const int FUNCAO_TANH = 8;
+const int FUNCAO_EXP = 9;
+const int FUNCAO_LOG = 10;
+const int FUNCAO_LOG10 = 11;
+const int FUNCAO_RAIZ = 12;
+const int FUNCAO_ABS = 13;
+const int FUNCAO_DESCONHECIDA = -1;
+
+// Token POD: para operadores 'codigo' guarda o proprio caractere, para funcoes o FUNCAO_*.
+struct Token {
+    int tipo;
+    int codigo;
+    double valor;
+    int precedencia;
+    bool associativo_direita;
+};
+
+// Trechos de ArenaAnalisador::programas (RPN) e ArenaAnalisador::textos (expressao) de uma expressao compilada.
+struct ProgramaRpn {
+    std::size_t inicio;
+    std::size_t tamanho;
+    std::size_t inicio_texto;
+    std::size_t tamanho_texto;
+};
+
+// Buffers reaproveitados entre analises. compilar_expressao e compilar_funcao acrescentam expressoes
+// na arena e limpar_programas descarta todas de uma vez, mantendo a capacidade; so chame
+// limpar_programas quando nenhuma funcao devolvida por compilar_funcao estiver mais em uso.
+// Com a capacidade ja aquecida, compilar e avaliar nao alocam memoria.
+struct ArenaAnalisador {
+    std::vector<Token> tokens;
+    std::vector<Token> fila_saida;
+    std::vector<Token> pilha_operadores;
+    std::vector<double> pilha_operandos;
+    std::vector<Token> programas;
+    std::string textos;
+    std::vector<ProgramaRpn> compilados;
+};
+
+ArenaAnalisador& obter_arena_analisador();
+void tokenizar(std::string_view expressao, std::vector<Token>& tokens);
+void shunting_yard(const std::vector<Token>& tokens_infix, std::vector<Token>& fila_saida, std::vector<Token>& pilha_operadores);
+double avaliar_rpn(const Token* tokens_rpn, std::size_t quantidade, double valor_x, std::vector<double>& pilha_operandos);
+double avaliar_rpn(const std::vector<Token>& tokens_rpn, double valor_x, std::vector<double>& pilha_operandos);
+double avaliar_rpn(const std::vector<Token>& tokens_rpn, double valor_x);
+std::string_view pre_processar_string_funcao_para_analise(std::string_view str_funcao);
+ProgramaRpn compilar_expressao(std::string_view str_funcao, ArenaAnalisador& arena);
+double avaliar_programa(const ArenaAnalisador& arena, ProgramaRpn programa, double valor_x);
+std::function<double(double)> compilar_funcao(std::string_view str_funcao, ArenaAnalisador& arena);
+void limpar_programas(ArenaAnalisador& arena);
+std::function<double(double)> analisar_string_funcao(const std::string& str_funcao);
+
+int obter_precedencia(char operador);
+int obter_codigo_funcao(std::string_view nome_funcao);
+const char* obter_nome_funcao(int codigo_funcao);
+double aplicar_operador(double operando1, double operando2, char operador);
+double aplicar_funcao_nomeada(int codigo_funcao, double valor_arg);
+
+#endif
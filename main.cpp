@@ -6,28 +6,11 @@
 #include <iomanip>
 #include <sstream>
 #include <cmath>
+#include "analisador_funcao.h"
+#include "metodos_numericos.h"
 
 using namespace std;
 
-using Token = tuple<int, string, int, bool>;
-vector<Token> tokenizar(const string& expressao);
-vector<Token> shunting_yard(const vector<Token>& tokens_infix);
-double avaliar_rpn(const vector<Token>& tokens_rpn, double valor_x);
-string pre_processar_string_funcao_para_analise(const string& str_funcao);
-function<double(double)> analisar_string_funcao(const string& str_funcao);
-
-void registrarResultado(const std::string& nome_metodo, double raiz, double valor_funcao, double erro, int iteracoes);
-
-double bissecao(const function<double(double)>& funcao, double a_val, double b_val, double tolerancia, int max_iteracoes, int& iteracoes_realizadas, double& diferenca_final);
-
-double iteracao_ponto_fixo(const function<double(double)>& funcao_f, const function<double(double)>& funcao_g, double x0_val, double tolerancia, int max_iteracoes, int& iteracoes_realizadas, double& diferenca_final);
-
-double newton(const function<double(double)>& funcao_f, const function<double(double)>& funcao_df, double x0_val, double tolerancia, int max_iteracoes, int& iteracoes_realizadas, double& diferenca_final);
-
-double secante(const function<double(double)>& funcao, double x0_val, double x1_val, double tolerancia, int max_iteracoes, int& iteracoes_realizadas, double& diferenca_final);
-
-double falsa_posicao(const function<double(double)>& funcao, double a_val, double b_val, double tolerancia, int max_iteracoes, int& iteracoes_realizadas, double& diferenca_final);
-
 
 string remover_espacos(const string& str) {
     size_t inicio = str.find_first_not_of(" \t\n\r\f\v");
@@ -37,8 +20,27 @@ string remover_espacos(const string& str) {
 }
 
 
+// Campos opcionais apos MAX_ITERACOES: MAX_AVALIACOES e TEMPO_LIMITE (segundos); vazio ou 0 = sem limite.
+void ler_orcamento(stringstream& stream_linha, int& max_avaliacoes, double& tempo_limite) {
+    string str_max_avaliacoes, str_tempo_limite;
+    max_avaliacoes = 0;
+    tempo_limite = 0.0;
+    if (getline(stream_linha, str_max_avaliacoes, ';') && !remover_espacos(str_max_avaliacoes).empty()) {
+        max_avaliacoes = stoi(str_max_avaliacoes);
+    }
+    if (getline(stream_linha, str_tempo_limite, ';') && !remover_espacos(str_tempo_limite).empty()) {
+        tempo_limite = stod(str_tempo_limite);
+    }
+}
+
+void imprimir_orcamento(int max_avaliacoes, double tempo_limite) {
+    if (max_avaliacoes > 0) cout << "Max Avaliacoes: " << max_avaliacoes << endl;
+    if (tempo_limite > 0) cout << "Tempo Limite: " << tempo_limite << " s" << endl;
+}
+
+
 void imprimir_resultados(const string& nome_metodo, const string& str_funcao, 
-                         double raiz, const function<double(double)>& funcao_f,
+                         double raiz, double residuo_final,
                          double diferenca_final, int iteracoes_realizadas) {    
     static bool cabecalho_escrito = false;
     static ofstream arquivo_saida("resultados_finais.txt", ios::out);
@@ -54,7 +56,7 @@ void imprimir_resultados(const string& nome_metodo, const string& str_funcao,
     arquivo_saida << left << setw(15) << nome_metodo
                   << setw(30) << str_funcao
                   << setw(15) << fixed << setprecision(8) << raiz
-                  << setw(15) << fabs(funcao_f(raiz))
+                  << setw(15) << fabs(residuo_final)
                   << setw(15) << diferenca_final
                   << setw(20) << iteracoes_realizadas << endl;
 }
@@ -75,6 +77,7 @@ int main() {
     
     string linha;
     int numero_linha = 0;
+    ArenaAnalisador& arena = obter_arena_analisador();
     remove("iteracoes.txt");
     while (getline(arquivo_entrada, linha)) {
         numero_linha++;
@@ -97,6 +100,9 @@ int main() {
         getline(stream_linha, tipo_metodo_str, ';');
         tipo_metodo_str = remover_espacos(tipo_metodo_str);
 
+        // As funcoes da linha anterior ja sairam de escopo; reaproveita a arena sem alocar.
+        limpar_programas(arena);
+
         try {
 
             if (tipo_metodo_str == "BISSECAO") {
@@ -107,22 +113,28 @@ int main() {
                 getline(stream_linha, str_epsilon, ';');
                 getline(stream_linha, str_max_iteracoes, ';');
 
-                function<double(double)> funcao_f = analisar_string_funcao(str_funcao);
+                function<double(double)> funcao_f = compilar_funcao(str_funcao, arena);
                 double valor_a = stod(str_a);
                 double valor_b = stod(str_b);
                 double epsilon = stod(str_epsilon);
                 int max_iteracoes = stoi(str_max_iteracoes);
+                int max_avaliacoes = 0;
+                double tempo_limite = 0.0;
+                ler_orcamento(stream_linha, max_avaliacoes, tempo_limite);
 
                 cout << "Metodo: Bissecao" << endl;
                 cout << "Funcao: " << str_funcao << endl;
                 cout << "Intervalo: [" << valor_a << ", " << valor_b << "]" << endl;
                 cout << "Epsilon: " << epsilon << ", Max Iteracoes: " << max_iteracoes << endl;
+                imprimir_orcamento(max_avaliacoes, tempo_limite);
 
+                memorizar_avaliacoes(funcao_f, max_avaliacoes, tempo_limite);
                 int iteracoes_realizadas = 0;
                 double diferenca_final = 0.0;
-                double raiz = bissecao(funcao_f, valor_a, valor_b, epsilon, max_iteracoes, iteracoes_realizadas, diferenca_final);
+                double residuo_final = 0.0;
+                double raiz = bissecao(funcao_f, valor_a, valor_b, epsilon, max_iteracoes, iteracoes_realizadas, diferenca_final, residuo_final);
 
-                imprimir_resultados("Bissecao", str_funcao, raiz, funcao_f, diferenca_final, iteracoes_realizadas);
+                imprimir_resultados("Bissecao", str_funcao, raiz, residuo_final, diferenca_final, iteracoes_realizadas);
             } 
 
             else if (tipo_metodo_str == "ITERACAO_PONTO_FIXO" || tipo_metodo_str == "MIL") {
@@ -133,23 +145,29 @@ int main() {
                 getline(stream_linha, str_epsilon, ';');
                 getline(stream_linha, str_max_iteracoes, ';');
 
-                function<double(double)> funcao_f = analisar_string_funcao(str_funcao_f);
-                function<double(double)> funcao_g = analisar_string_funcao(str_funcao_g);
+                function<double(double)> funcao_f = compilar_funcao(str_funcao_f, arena);
+                function<double(double)> funcao_g = compilar_funcao(str_funcao_g, arena);
                 double valor_x0 = stod(str_x0);
                 double epsilon = stod(str_epsilon);
                 int max_iteracoes = stoi(str_max_iteracoes);
+                int max_avaliacoes = 0;
+                double tempo_limite = 0.0;
+                ler_orcamento(stream_linha, max_avaliacoes, tempo_limite);
 
                 cout << "Metodo: Iteracao de Ponto Fixo (MIL)" << endl;
                 cout << "Funcao f(x): " << str_funcao_f << endl;
                 cout << "Funcao g(x): " << str_funcao_g << endl;
                 cout << "x0: " << valor_x0 << endl;
                 cout << "Epsilon: " << epsilon << ", Max Iteracoes: " << max_iteracoes << endl;
+                imprimir_orcamento(max_avaliacoes, tempo_limite);
 
+                memorizar_avaliacoes(funcao_f, funcao_g, max_avaliacoes, tempo_limite);
                 int iteracoes_realizadas = 0;
                 double diferenca_final = 0.0;
-                double raiz = iteracao_ponto_fixo(funcao_f, funcao_g, valor_x0, epsilon, max_iteracoes, iteracoes_realizadas, diferenca_final);
+                double residuo_final = 0.0;
+                double raiz = iteracao_ponto_fixo(funcao_f, funcao_g, valor_x0, epsilon, max_iteracoes, iteracoes_realizadas, diferenca_final, residuo_final);
 
-                imprimir_resultados("Ponto Fixo(MIL)", str_funcao_f, raiz, funcao_f, diferenca_final, iteracoes_realizadas);
+                imprimir_resultados("Ponto Fixo(MIL)", str_funcao_f, raiz, residuo_final, diferenca_final, iteracoes_realizadas);
             } 
 
             else if (tipo_metodo_str == "NEWTON") {
@@ -160,23 +178,29 @@ int main() {
                 getline(stream_linha, str_epsilon, ';');
                 getline(stream_linha, str_max_iteracoes, ';');
 
-                function<double(double)> funcao_f = analisar_string_funcao(str_funcao_f);   
-                function<double(double)> funcao_df= analisar_string_funcao(str_funcao_df);
+                function<double(double)> funcao_f = compilar_funcao(str_funcao_f, arena);   
+                function<double(double)> funcao_df= compilar_funcao(str_funcao_df, arena);
                 double valor_x0 = stod(str_x0);
                 double epsilon = stod(str_epsilon);
                 int max_iteracoes = stoi(str_max_iteracoes);
+                int max_avaliacoes = 0;
+                double tempo_limite = 0.0;
+                ler_orcamento(stream_linha, max_avaliacoes, tempo_limite);
 
                 cout << "Metodo: Newton" << endl;
                 cout << "Funcao f(x): " << str_funcao_f << endl;
                 cout << "Funcao df(x): " <<str_funcao_df << endl;
                 cout << "x0: " << valor_x0 << endl;
                 cout << "Epsilon: " << epsilon << ", Max Iteracoes: " << max_iteracoes << endl;
+                imprimir_orcamento(max_avaliacoes, tempo_limite);
 
+                memorizar_avaliacoes(funcao_f, funcao_df, max_avaliacoes, tempo_limite);
                 int iteracoes_realizadas = 0;
                 double diferenca_final = 0.0;
-                double raiz = newton(funcao_f, funcao_df, valor_x0, epsilon, max_iteracoes, iteracoes_realizadas, diferenca_final);
+                double residuo_final = 0.0;
+                double raiz = newton(funcao_f, funcao_df, valor_x0, epsilon, max_iteracoes, iteracoes_realizadas, diferenca_final, residuo_final);
 
-                imprimir_resultados("Newton", str_funcao_f, raiz, funcao_f, diferenca_final, iteracoes_realizadas);
+                imprimir_resultados("Newton", str_funcao_f, raiz, residuo_final, diferenca_final, iteracoes_realizadas);
             } 
 
             else if (tipo_metodo_str == "SECANTE") {
@@ -187,22 +211,28 @@ int main() {
                 getline(stream_linha, str_epsilon, ';');
                 getline(stream_linha, str_max_iteracoes, ';');
 
-                function<double(double)> funcao_f = analisar_string_funcao(str_funcao);
+                function<double(double)> funcao_f = compilar_funcao(str_funcao, arena);
                 double valor_x0 = stod(str_x0);
                 double valor_x1 = stod(str_x1);
                 double epsilon = stod(str_epsilon);
                 int max_iteracoes = stoi(str_max_iteracoes);
+                int max_avaliacoes = 0;
+                double tempo_limite = 0.0;
+                ler_orcamento(stream_linha, max_avaliacoes, tempo_limite);
 
                 cout << "Metodo: Secante" << endl;
                 cout << "Funcao: " << str_funcao << endl;
                 cout << "x0: " << valor_x0 << ", x1: " << valor_x1 << endl;
                 cout << "Epsilon: " << epsilon << ", Max Iteracoes: " << max_iteracoes << endl;
+                imprimir_orcamento(max_avaliacoes, tempo_limite);
 
+                memorizar_avaliacoes(funcao_f, max_avaliacoes, tempo_limite);
                 int iteracoes_realizadas = 0;
                 double diferenca_final = 0.0;
-                double raiz = secante(funcao_f, valor_x0, valor_x1, epsilon, max_iteracoes, iteracoes_realizadas, diferenca_final);
+                double residuo_final = 0.0;
+                double raiz = secante(funcao_f, valor_x0, valor_x1, epsilon, max_iteracoes, iteracoes_realizadas, diferenca_final, residuo_final);
 
-                imprimir_resultados("Secante", str_funcao, raiz, funcao_f, diferenca_final, iteracoes_realizadas);
+                imprimir_resultados("Secante", str_funcao, raiz, residuo_final, diferenca_final, iteracoes_realizadas);
             } 
 
             else if (tipo_metodo_str == "REGULA_FALSI") {
@@ -213,22 +243,64 @@ int main() {
                 getline(stream_linha, str_epsilon, ';');
                 getline(stream_linha, str_max_iteracoes, ';');
 
-                function<double(double)> funcao_f = analisar_string_funcao(str_funcao);
+                function<double(double)> funcao_f = compilar_funcao(str_funcao, arena);
                 double valor_a = stod(str_a);
                 double valor_b = stod(str_b);
                 double epsilon = stod(str_epsilon);
                 int max_iteracoes = stoi(str_max_iteracoes);
+                int max_avaliacoes = 0;
+                double tempo_limite = 0.0;
+                ler_orcamento(stream_linha, max_avaliacoes, tempo_limite);
 
                 cout << "Metodo: Regula Falsi" << endl;
                 cout << "Funcao: " << str_funcao << endl;
                 cout << "Intervalo: [" << valor_a << ", " << valor_b << "]" << endl;
                 cout << "Epsilon: " << epsilon << ", Max Iteracoes: " << max_iteracoes << endl;
+                imprimir_orcamento(max_avaliacoes, tempo_limite);
+
+                memorizar_avaliacoes(funcao_f, max_avaliacoes, tempo_limite);
+                int iteracoes_realizadas = 0;
+                double diferenca_final = 0.0;
+                double residuo_final = 0.0;
+                double raiz = falsa_posicao(funcao_f, valor_a, valor_b, epsilon, max_iteracoes, iteracoes_realizadas, diferenca_final, residuo_final);
+
+                imprimir_resultados("Regula Falsi", str_funcao, raiz, residuo_final, diferenca_final, iteracoes_realizadas);
+            } 
+
+            else if (tipo_metodo_str == "AUTO") {
+                string str_funcao_f, str_funcao_df, str_a, str_b, str_epsilon, str_max_iteracoes;
+                getline(stream_linha, str_funcao_f, ';');
+                getline(stream_linha, str_funcao_df, ';');
+                getline(stream_linha, str_a, ';');
+                getline(stream_linha, str_b, ';');
+                getline(stream_linha, str_epsilon, ';');
+                getline(stream_linha, str_max_iteracoes, ';');
+
+                function<double(double)> funcao_f = compilar_funcao(str_funcao_f, arena);
+                function<double(double)> funcao_df = compilar_funcao(str_funcao_df, arena);
+                double valor_a = stod(str_a);
+                double valor_b = stod(str_b);
+                double epsilon = stod(str_epsilon);
+                int max_iteracoes = stoi(str_max_iteracoes);
+                int max_avaliacoes = 0;
+                double tempo_limite = 0.0;
+                ler_orcamento(stream_linha, max_avaliacoes, tempo_limite);
+
+                cout << "Metodo: Auto (Newton, Secante, Regula Falsi e Bissecao em paralelo)" << endl;
+                cout << "Funcao f(x): " << str_funcao_f << endl;
+                cout << "Funcao df(x): " << str_funcao_df << endl;
+                cout << "Intervalo: [" << valor_a << ", " << valor_b << "]" << endl;
+                cout << "Epsilon: " << epsilon << ", Max Iteracoes: " << max_iteracoes << endl;
+                imprimir_orcamento(max_avaliacoes, tempo_limite);
 
                 int iteracoes_realizadas = 0;
                 double diferenca_final = 0.0;
-                double raiz = falsa_posicao(funcao_f, valor_a, valor_b, epsilon, max_iteracoes, iteracoes_realizadas, diferenca_final);
+                double residuo_final = 0.0;
+                string metodo_vencedor;
+                double raiz = metodo_automatico(funcao_f, funcao_df, valor_a, valor_b, epsilon, max_iteracoes, max_avaliacoes, tempo_limite, iteracoes_realizadas, diferenca_final, residuo_final, metodo_vencedor);
 
-                imprimir_resultados("Regula Falsi", str_funcao, raiz, funcao_f, diferenca_final, iteracoes_realizadas);
+                cout << "Metodo vencedor: " << metodo_vencedor << endl;
+                imprimir_resultados("Auto(" + metodo_vencedor + ")", str_funcao_f, raiz, residuo_final, diferenca_final, iteracoes_realizadas);
             } 
 
             else {
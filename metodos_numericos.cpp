@@ -5,25 +5,25 @@
 #include <functional>
 #include <iomanip>
 #include <fstream>
+#include <vector>
+#include <thread>
+#include <mutex>
+#include <atomic>
+#include <condition_variable>
+#include <memory>
+#include <chrono>
+#include "metodos_numericos.h"
 
 using namespace std;
 
-void registrarResultado(const std::string& nome_metodo, double raiz, double valor_funcao, double erro, int iteracoes);
-
-double bissecao(const function<double(double)>& funcao, double a_val, double b_val, double tolerancia, int max_iteracoes, int& iteracoes_realizadas, double& diferenca_final);
-
-double iteracao_ponto_fixo(const function<double(double)>& funcao_f, const function<double(double)>& funcao_g, double x0_val, double tolerancia, int max_iteracoes, int& iteracoes_realizadas, double& diferenca_final);
-
-double newton(const function<double(double)>& funcao_f, const function<double(double)>& funcao_df, double x0_val, double tolerancia, int max_iteracoes, int& iteracoes_realizadas, double& diferenca_final);
-
-double secante(const function<double(double)>& funcao, double x0_val, double x1_val, double tolerancia, int max_iteracoes, int& iteracoes_realizadas, double& diferenca_final);
-
-double falsa_posicao(const function<double(double)>& funcao, double a_val, double b_val, double tolerancia, int max_iteracoes, int& iteracoes_realizadas, double& diferenca_final);
-
+void preparar_iteracao(EstadoSolver& estado);
+void falhar_solver(EstadoSolver& estado, const string& mensagem);
 
 void registrarResultado(const string& nome_metodo, double raiz, double valor_funcao, double erro, int iteracoes) {
     static bool cabecalho_escrito = false;
     static ofstream arquivo_saida("iteracoes.txt", ios::app);
+    static mutex mutex_arquivo;
+    lock_guard<mutex> trava(mutex_arquivo);
 
     if (!cabecalho_escrito) {
         arquivo_saida << left << setw(20) << "Metodo"
@@ -40,215 +40,465 @@ void registrarResultado(const string& nome_metodo, double raiz, double valor_fun
                   << left << setw(20) << fixed << setprecision(8) << erro
                   << left << setw(10) << iteracoes + 1 << endl;
 }
-double bissecao(const function<double(double)>& funcao, double a_val, double b_val, double tolerancia, int max_iteracoes, int& iteracoes_realizadas, double& diferenca_final) {
-
-    double fa = funcao(a_val);
-    double fb = funcao(b_val);
-    
-    if (fa * fb >= 0) {
-        throw runtime_error("Erro (Bisseção): A função deve ter sinais opostos nos limites a e b.");
-    }
-    
-    double c_val = a_val;
-    double c_anterior = a_val;
-    double fc;
-    
-    for (int i = 0; i < max_iteracoes; ++i) {
-
-        c_val = (a_val + b_val) / 2;
-        fc = funcao(c_val);
 
-        diferenca_final = abs(c_val - c_anterior);
-
-        registrarResultado("Bisecção", c_val, fc, diferenca_final, i);
+// Lancada pelas funcoes memorizadas quando o orcamento de avaliacoes ou de tempo da resolucao acaba.
+class OrcamentoEsgotado : public runtime_error {
+public:
+    explicit OrcamentoEsgotado(const string& mensagem) : runtime_error(mensagem) {}
+};
+
+const int TAMANHO_MEMO_AVALIACOES = 8;
+
+// Ultimos pares (x, f(x)) de uma funcao; os metodos so revisitam pontos recentes.
+// Cada funcao memorizada tem o seu e e usada por uma unica resolucao (uma thread), sem trava.
+struct MemoAvaliacoes {
+    double x[TAMANHO_MEMO_AVALIACOES];
+    double valor[TAMANHO_MEMO_AVALIACOES];
+    int quantidade = 0;
+    int proxima = 0;
+};
+
+// Orcamento de uma resolucao, dividido entre f e a funcao auxiliar. O prazo e fixo desde a criacao.
+struct OrcamentoAvaliacoes {
+    atomic<int> avaliacoes{0};
+    int max_avaliacoes = 0;
+    double tempo_limite = 0.0;
+    chrono::steady_clock::time_point prazo;
+};
+
+shared_ptr<OrcamentoAvaliacoes> criar_orcamento(int max_avaliacoes, double tempo_limite, chrono::steady_clock::time_point inicio) {
+    shared_ptr<OrcamentoAvaliacoes> orcamento = make_shared<OrcamentoAvaliacoes>();
+    orcamento->max_avaliacoes = max_avaliacoes;
+    orcamento->tempo_limite = tempo_limite;
+    orcamento->prazo = inicio + chrono::duration_cast<chrono::steady_clock::duration>(chrono::duration<double>(tempo_limite));
+    return orcamento;
+}
 
-        if (abs(fc) < tolerancia || diferenca_final < tolerancia) {
-            iteracoes_realizadas = i + 1;
-            return c_val;
+function<double(double)> criar_funcao_memorizada(const function<double(double)>& funcao, shared_ptr<OrcamentoAvaliacoes> orcamento) {
+    shared_ptr<MemoAvaliacoes> memo = make_shared<MemoAvaliacoes>();
+    return [funcao, orcamento, memo](double x) {
+        // Os limites valem para toda avaliacao pedida pelo metodo, antes do cache: um metodo que so
+        // repete pontos ja avaliados (ciclando) tambem para. O cache so poupa o custo de recalcular.
+        if (orcamento->max_avaliacoes > 0 && orcamento->avaliacoes.fetch_add(1, memory_order_relaxed) >= orcamento->max_avaliacoes) {
+            throw OrcamentoEsgotado("Orçamento de " + to_string(orcamento->max_avaliacoes) + " avaliações esgotado.");
         }
-
-        c_anterior = c_val;
-
-        if (fc * fa < 0) {
-            b_val = c_val;
-            fb = fc;
-        } else {
-            a_val = c_val;
-            fa = fc;
+        if (orcamento->tempo_limite > 0 && chrono::steady_clock::now() >= orcamento->prazo) {
+            throw OrcamentoEsgotado("Tempo limite de " + to_string(orcamento->tempo_limite) + " s esgotado.");
         }
-    }
-
-    iteracoes_realizadas = max_iteracoes;
-    diferenca_final = abs(c_val - c_anterior);
-    
-    cerr << "Aviso (Bisseção): Convergência não alcançada em " << max_iteracoes 
-         << " iterações. Erro atual: " << setprecision(10) << abs(fc) << endl;
-         
-    return c_val;
+        for (int i = 0; i < memo->quantidade; ++i) {
+            if (memo->x[i] == x) return memo->valor[i];
+        }
+        double valor = funcao(x);
+        memo->x[memo->proxima] = x;
+        memo->valor[memo->proxima] = valor;
+        memo->proxima = (memo->proxima + 1) % TAMANHO_MEMO_AVALIACOES;
+        if (memo->quantidade < TAMANHO_MEMO_AVALIACOES) memo->quantidade++;
+        return valor;
+    };
 }
 
-double iteracao_ponto_fixo(const function<double(double)>& funcao_f, const function<double(double)>& funcao_g, double x0_val, double tolerancia, int max_iteracoes, int& iteracoes_realizadas, double& diferenca_final) {
-    double x_anterior = x0_val;
-    double x_proximo = x0_val;
-    double fx_proximo;
-    
-    for (int i = 0; i < max_iteracoes; ++i) {
-
-        x_proximo = funcao_g(x_anterior);
-        fx_proximo = funcao_f(x_proximo);
-
-        diferenca_final = abs(x_proximo - x_anterior);
-        
-        registrarResultado("Ponto Fixo", x_proximo, fx_proximo, diferenca_final,i);
+void memorizar_avaliacoes(function<double(double)>& funcao_f, function<double(double)>& funcao_auxiliar, shared_ptr<OrcamentoAvaliacoes> orcamento) {
+    funcao_f = criar_funcao_memorizada(funcao_f, orcamento);
+    if (funcao_auxiliar) {
+        funcao_auxiliar = criar_funcao_memorizada(funcao_auxiliar, orcamento);
+    }
+}
 
-        if (abs(fx_proximo) < tolerancia || diferenca_final < tolerancia) {
-            iteracoes_realizadas = i + 1;
-            return x_proximo;
-        }
+// Troca f (e a auxiliar, se houver) por versoes memorizadas que dividem o mesmo orcamento.
+// O prazo de tempo comeca a contar aqui; max_avaliacoes ou tempo_limite <= 0 significa sem limite.
+void memorizar_avaliacoes(function<double(double)>& funcao_f, function<double(double)>& funcao_auxiliar, int max_avaliacoes, double tempo_limite) {
+    memorizar_avaliacoes(funcao_f, funcao_auxiliar, criar_orcamento(max_avaliacoes, tempo_limite, chrono::steady_clock::now()));
+}
 
-        x_anterior = x_proximo;
+void memorizar_avaliacoes(function<double(double)>& funcao_f, int max_avaliacoes, double tempo_limite) {
+    function<double(double)> sem_auxiliar;
+    memorizar_avaliacoes(funcao_f, sem_auxiliar, max_avaliacoes, tempo_limite);
+}
 
-    }
+EstadoSolver iniciar_bissecao(double a_val, double b_val, double tolerancia, int max_iteracoes) {
+    EstadoSolver estado;
+    estado.metodo = METODO_BISSECAO;
+    estado.fase = FASE_INICIO_A;
+    estado.x_pendente = a_val;
+    estado.a = a_val;
+    estado.b = b_val;
+    estado.x = a_val;
+    estado.x_anterior = a_val;
+    estado.tolerancia = tolerancia;
+    estado.max_iteracoes = max_iteracoes;
+    return estado;
+}
 
-    iteracoes_realizadas = max_iteracoes;
-    diferenca_final = abs(x_proximo - x_anterior);
-    
-    cerr << "Aviso (MIL): Convergência não alcançada em " << max_iteracoes 
-         << " iterações. Erro atual: " << setprecision(10) << abs(fx_proximo) << endl;
-         
-    return x_proximo;
+EstadoSolver iniciar_ponto_fixo(double x0_val, double tolerancia, int max_iteracoes) {
+    EstadoSolver estado;
+    estado.metodo = METODO_PONTO_FIXO;
+    estado.fase = FASE_NOVO_PONTO;
+    estado.x_pendente = x0_val;
+    estado.x = x0_val;
+    estado.x_anterior = x0_val;
+    estado.tolerancia = tolerancia;
+    estado.max_iteracoes = max_iteracoes;
+    preparar_iteracao(estado);
+    return estado;
 }
 
-double newton(const function<double(double)>& funcao_f, const function<double(double)>& funcao_df, double x0_val, double tolerancia, int max_iteracoes, int& iteracoes_realizadas, double& diferenca_final) {
-    double x_anterior = x0_val;
-    double x_proximo = x0_val;
-    double fx, dfx;
-    
-    for (int i = 0; i < max_iteracoes; ++i) {
+EstadoSolver iniciar_newton(double x0_val, double tolerancia, int max_iteracoes) {
+    EstadoSolver estado;
+    estado.metodo = METODO_NEWTON;
+    estado.fase = FASE_INICIO_B;
+    estado.x_pendente = x0_val;
+    estado.x = x0_val;
+    estado.x_anterior = x0_val;
+    estado.tolerancia = tolerancia;
+    estado.max_iteracoes = max_iteracoes;
+    return estado;
+}
 
-        fx = funcao_f(x_anterior);
-        dfx = funcao_df(x_anterior);
+EstadoSolver iniciar_secante(double x0_val, double x1_val, double tolerancia, int max_iteracoes) {
+    EstadoSolver estado;
+    estado.metodo = METODO_SECANTE;
+    estado.fase = FASE_INICIO_A;
+    estado.x_pendente = x0_val;
+    estado.x = x1_val;
+    estado.x_anterior = x0_val;
+    estado.tolerancia = tolerancia;
+    estado.max_iteracoes = max_iteracoes;
+    return estado;
+}
 
-        if (abs(dfx) < 1e-12) 
-            throw runtime_error("Erro (Newton): Derivada próxima de zero em x = " + to_string(x_anterior));
+EstadoSolver iniciar_falsa_posicao(double a_val, double b_val, double tolerancia, int max_iteracoes) {
+    EstadoSolver estado = iniciar_bissecao(a_val, b_val, tolerancia, max_iteracoes);
+    estado.metodo = METODO_FALSA_POSICAO;
+    return estado;
+}
 
-        x_proximo = x_anterior - fx / dfx;
+void falhar_solver(EstadoSolver& estado, const string& mensagem) {
+    estado.situacao = SOLVER_FALHOU;
+    estado.erro = mensagem;
+}
 
-        diferenca_final = abs(x_proximo - x_anterior);
-        double fx_proximo = funcao_f(x_proximo);
-        
-        registrarResultado("Newton", x_proximo, funcao_f(x_proximo), diferenca_final, i);
+void preparar_iteracao(EstadoSolver& estado) {
+    if (estado.iteracao >= estado.max_iteracoes) {
+        estado.situacao = SOLVER_ESGOTADO;
+        return;
+    }
+    estado.avaliacao_pendente = AVALIAR_F;
+    estado.fase = FASE_NOVO_PONTO;
 
-        if (abs(fx_proximo) < tolerancia || diferenca_final < tolerancia) {
-            iteracoes_realizadas = i + 1;
-            return x_proximo;
+    if (estado.metodo == METODO_BISSECAO) {
+        estado.x_pendente = (estado.a + estado.b) / 2;
+    }
+    else if (estado.metodo == METODO_FALSA_POSICAO) {
+        if (abs(estado.fb - estado.fa) < 1e-12) {
+            falhar_solver(estado, "Erro (Regula Falsi): f(b) e f(a) são muito próximos, divisão por zero iminente.");
+            return;
         }
-
-        x_anterior = x_proximo;
+        estado.x_pendente = (estado.a * estado.fb - estado.b * estado.fa) / (estado.fb - estado.fa);
+    }
+    else if (estado.metodo == METODO_SECANTE) {
+        if (abs(estado.fx - estado.fx_anterior) < 1e-12) {
+            falhar_solver(estado, "Erro (Secante): f(x1) e f(x0) são muito próximos, divisão por zero iminente.");
+            return;
+        }
+        estado.x_pendente = estado.x - estado.fx * (estado.x - estado.x_anterior) / (estado.fx - estado.fx_anterior);
+    }
+    else {
+        // Newton pede df(x) e o ponto fixo pede g(x) antes do novo ponto.
+        estado.avaliacao_pendente = AVALIAR_AUXILIAR;
+        estado.fase = FASE_AUXILIAR;
+        estado.x_pendente = estado.x;
     }
-
-    iteracoes_realizadas = max_iteracoes;
-    diferenca_final = abs(x_proximo - x_anterior);
-    
-    cerr << "Aviso (Newton): Convergência não alcançada em " << max_iteracoes 
-         << " iterações. Erro atual: " << setprecision(10) << abs(funcao_f(x_proximo)) << endl;
-         
-    return x_proximo;
 }
 
-double secante(const function<double(double)>& funcao, double x0_val, double x1_val, double tolerancia, int max_iteracoes, int& iteracoes_realizadas, double& diferenca_final) {
-    double x0 = x0_val;
-    double x1 = x1_val;
-    double fx0 = funcao(x0);
-    double fx1 = funcao(x1);
-    double x_proximo, fx_proximo;
+bool fornecer_avaliacao(EstadoSolver& estado, double valor) {
+    if (estado.situacao != SOLVER_EM_ANDAMENTO) {
+        throw runtime_error("Erro: avaliação fornecida a um solver já encerrado.");
+    }
 
-    if (abs(fx0 - fx1) < 1e-12) {
-        throw runtime_error("Erro (Secante): f(x0) e f(x1) são muito próximos, divisão por zero iminente.");
+    if (estado.fase == FASE_INICIO_A) {
+        // Bissecao e Regula Falsi: f(a); Secante: f(x0).
+        estado.fa = valor;
+        estado.fx_anterior = valor;
+        if (estado.metodo != METODO_SECANTE) {
+            estado.fx = valor;   // x comeca em a
+        }
+        estado.fase = FASE_INICIO_B;
+        estado.x_pendente = (estado.metodo == METODO_SECANTE) ? estado.x : estado.b;
+        return false;
     }
 
-    for (int i = 0; i < max_iteracoes; ++i) {
+    if (estado.fase == FASE_INICIO_B) {
+        if (estado.metodo == METODO_BISSECAO || estado.metodo == METODO_FALSA_POSICAO) {
+            estado.fb = valor;
+            if (estado.fa * estado.fb >= 0) {
+                falhar_solver(estado, estado.metodo == METODO_BISSECAO
+                    ? "Erro (Bisseção): A função deve ter sinais opostos nos limites a e b."
+                    : "Erro (Regula Falsi): A função deve ter sinais opostos nos limites a e b.");
+                return false;
+            }
+        } else {
+            // Secante: f(x1); Newton: f(x0).
+            estado.fx = valor;
+            if (estado.metodo == METODO_SECANTE && abs(estado.fx_anterior - estado.fx) < 1e-12) {
+                falhar_solver(estado, "Erro (Secante): f(x0) e f(x1) são muito próximos, divisão por zero iminente.");
+                return false;
+            }
+        }
+        preparar_iteracao(estado);
+        return false;
+    }
 
-        if (abs(fx1 - fx0) < 1e-12) {
-            throw runtime_error("Erro (Secante): f(x1) e f(x0) são muito próximos, divisão por zero iminente.");
+    if (estado.fase == FASE_AUXILIAR) {
+        if (estado.metodo == METODO_NEWTON) {
+            if (abs(valor) < 1e-12) {
+                falhar_solver(estado, "Erro (Newton): Derivada próxima de zero em x = " + to_string(estado.x));
+                return false;
+            }
+            estado.x_pendente = estado.x - estado.fx / valor;
+        } else {
+            estado.x_pendente = valor;
         }
+        estado.avaliacao_pendente = AVALIAR_F;
+        estado.fase = FASE_NOVO_PONTO;
+        return false;
+    }
+
+    // FASE_NOVO_PONTO: valor = f(x_pendente), fecha uma iteracao.
+    double x_novo = estado.x_pendente;
+    estado.iteracao++;
+
+    if (estado.metodo == METODO_SECANTE) {
+        estado.diferenca = abs(x_novo - estado.x);
+        estado.x_anterior = estado.x;
+        estado.fx_anterior = estado.fx;
+    } else if (estado.metodo == METODO_BISSECAO || estado.metodo == METODO_FALSA_POSICAO) {
+        estado.diferenca = abs(x_novo - estado.x_anterior);
+    } else {
+        estado.diferenca = abs(x_novo - estado.x);
+    }
+    estado.x = x_novo;
+    estado.fx = valor;
 
-        x_proximo = x1 - fx1 * (x1 - x0) / (fx1 - fx0);
-        fx_proximo = funcao(x_proximo);
+    if (abs(estado.fx) < estado.tolerancia || estado.diferenca < estado.tolerancia) {
+        estado.situacao = SOLVER_CONVERGIU;
+        return true;
+    }
 
-        diferenca_final = abs(x_proximo - x1);
+    if (estado.metodo != METODO_SECANTE) {
+        estado.x_anterior = estado.x;
+    }
+    if (estado.metodo == METODO_BISSECAO || estado.metodo == METODO_FALSA_POSICAO) {
+        if (estado.fx * estado.fa < 0) {
+            estado.b = estado.x;
+            estado.fb = estado.fx;
+        } else {
+            estado.a = estado.x;
+            estado.fa = estado.fx;
+        }
+    }
+    preparar_iteracao(estado);
+    return true;
+}
 
-        registrarResultado("Secante", x_proximo, fx_proximo, diferenca_final,i);
+bool passo_solver(EstadoSolver& estado, const function<double(double)>& funcao_f, const function<double(double)>& funcao_auxiliar) {
+    while (estado.situacao == SOLVER_EM_ANDAMENTO) {
+        const function<double(double)>& funcao = (estado.avaliacao_pendente == AVALIAR_F) ? funcao_f : funcao_auxiliar;
+        if (fornecer_avaliacao(estado, funcao(estado.x_pendente))) {
+            return true;
+        }
+    }
+    return false;
+}
 
-        if (abs(fx_proximo) < tolerancia || diferenca_final < tolerancia) {
-            iteracoes_realizadas = i + 1;
-            return x_proximo;
+double executar_solver(EstadoSolver& estado, const string& nome_registro, const string& nome_aviso, const function<double(double)>& funcao_f, const function<double(double)>& funcao_auxiliar, int& iteracoes_realizadas, double& diferenca_final, double& residuo_final) {
+
+    while (estado.situacao == SOLVER_EM_ANDAMENTO) {
+        try {
+            if (passo_solver(estado, funcao_f, funcao_auxiliar)) {
+                diferenca_final = estado.diferenca;
+                registrarResultado(nome_registro, estado.x, estado.fx, estado.diferenca, estado.iteracao - 1);
+            }
+        } catch (const OrcamentoEsgotado& e) {
+            // Sem nenhuma iteracao concluida nao ha estimativa para devolver.
+            if (estado.iteracao == 0) {
+                throw runtime_error("Erro (" + nome_aviso + "): " + e.what());
+            }
+            iteracoes_realizadas = estado.iteracao;
+            residuo_final = abs(estado.fx);
+            cerr << "Aviso (" << nome_aviso << "): " << e.what() << " Parando após " << estado.iteracao
+                 << " iterações. Erro atual: " << setprecision(10) << abs(estado.fx) << endl;
+            return estado.x;
         }
+    }
+
+    // Mantem o contrato dos chamadores antigos: falha do metodo vira excecao.
+    if (estado.situacao == SOLVER_FALHOU) {
+        throw runtime_error(estado.erro);
+    }
 
-        x0 = x1;
-        x1 = x_proximo;
-        fx0 = fx1;
-        fx1 = fx_proximo;
+    if (estado.situacao == SOLVER_CONVERGIU) {
+        iteracoes_realizadas = estado.iteracao;
+        residuo_final = abs(estado.fx);
+        return estado.x;
     }
 
-    iteracoes_realizadas = max_iteracoes;
-    diferenca_final = abs(x1 - x0);
+    // So o MIL com max_iteracoes <= 0 termina sem ter avaliado f no ponto devolvido.
+    if (estado.metodo == METODO_PONTO_FIXO && estado.iteracao == 0) {
+        estado.fx = funcao_f(estado.x);
+    }
+    iteracoes_realizadas = estado.max_iteracoes;
+    diferenca_final = abs(estado.x - estado.x_anterior);
+    residuo_final = abs(estado.fx);
     
-    cerr << "Aviso (Secante): Convergência não alcançada em " << max_iteracoes 
-         << " iterações. Erro atual: " << setprecision(10) << abs(fx1) << endl;
+    cerr << "Aviso (" << nome_aviso << "): Convergência não alcançada em " << estado.max_iteracoes 
+         << " iterações. Erro atual: " << setprecision(10) << abs(estado.fx) << endl;
          
-    return x1;
+    return estado.x;
 }
 
-double falsa_posicao(const function<double(double)>& funcao, double a_val, double b_val, double tolerancia, int max_iteracoes,  int& iteracoes_realizadas, double& diferenca_final) {
+double bissecao(const function<double(double)>& funcao, double a_val, double b_val, double tolerancia, int max_iteracoes, int& iteracoes_realizadas, double& diferenca_final, double& residuo_final) {
+    EstadoSolver estado = iniciar_bissecao(a_val, b_val, tolerancia, max_iteracoes);
+    return executar_solver(estado, "Bisecção", "Bisseção", funcao, funcao, iteracoes_realizadas, diferenca_final, residuo_final);
+}
 
-    double a = a_val;
-    double b = b_val;
-    double fa = funcao(a);
-    double fb = funcao(b);
-    
-    if (fa * fb >= 0) {
-        throw runtime_error("Erro (Regula Falsi): A função deve ter sinais opostos nos limites a e b.");
-    }
-    
-    double c = a;
-    double c_anterior = a;
-    double fc;
-    
-    for (int i = 0; i < max_iteracoes; ++i) {
+double iteracao_ponto_fixo(const function<double(double)>& funcao_f, const function<double(double)>& funcao_g, double x0_val, double tolerancia, int max_iteracoes, int& iteracoes_realizadas, double& diferenca_final, double& residuo_final) {
+    EstadoSolver estado = iniciar_ponto_fixo(x0_val, tolerancia, max_iteracoes);
+    return executar_solver(estado, "Ponto Fixo", "MIL", funcao_f, funcao_g, iteracoes_realizadas, diferenca_final, residuo_final);
+}
 
-        if (abs(fb - fa) < 1e-12) {
-            throw runtime_error("Erro (Regula Falsi): f(b) e f(a) são muito próximos, divisão por zero iminente.");
-        }
+double newton(const function<double(double)>& funcao_f, const function<double(double)>& funcao_df, double x0_val, double tolerancia, int max_iteracoes, int& iteracoes_realizadas, double& diferenca_final, double& residuo_final) {
+    EstadoSolver estado = iniciar_newton(x0_val, tolerancia, max_iteracoes);
+    return executar_solver(estado, "Newton", "Newton", funcao_f, funcao_df, iteracoes_realizadas, diferenca_final, residuo_final);
+}
 
-        c = (a * fb - b * fa) / (fb - fa);
-        fc = funcao(c);
+double secante(const function<double(double)>& funcao, double x0_val, double x1_val, double tolerancia, int max_iteracoes, int& iteracoes_realizadas, double& diferenca_final, double& residuo_final) {
+    EstadoSolver estado = iniciar_secante(x0_val, x1_val, tolerancia, max_iteracoes);
+    return executar_solver(estado, "Secante", "Secante", funcao, funcao, iteracoes_realizadas, diferenca_final, residuo_final);
+}
 
-        diferenca_final = abs(c - c_anterior);
+double falsa_posicao(const function<double(double)>& funcao, double a_val, double b_val, double tolerancia, int max_iteracoes,  int& iteracoes_realizadas, double& diferenca_final, double& residuo_final) {
+    EstadoSolver estado = iniciar_falsa_posicao(a_val, b_val, tolerancia, max_iteracoes);
+    return executar_solver(estado, "Falsa Posição", "Regula Falsi", funcao, funcao, iteracoes_realizadas, diferenca_final, residuo_final);
+}
 
-        registrarResultado("Falsa Posição", c, fc, diferenca_final, i);
+// Lancada pela funcao envolvida quando outro metodo da corrida ja convergiu.
+class SolverCancelado : public runtime_error {
+public:
+    SolverCancelado() : runtime_error("Cancelado: outro metodo convergiu primeiro.") {}
+};
+
+struct ResultadoCorrida {
+    bool concluido = false;
+    bool convergiu = false;
+    double raiz = 0.0;
+    double residuo = 0.0;
+    int iteracoes = 0;
+    double diferenca = 0.0;
+    string erro;
+};
+
+double metodo_automatico(const function<double(double)>& funcao_f, const function<double(double)>& funcao_df, double a_val, double b_val, double tolerancia, int max_iteracoes, int max_avaliacoes, double tempo_limite, int& iteracoes_realizadas, double& diferenca_final, double& residuo_final, string& metodo_vencedor) {
+
+    if (max_iteracoes <= 0) {
+        throw runtime_error("Erro (Auto): MAX_ITERACOES deve ser positivo.");
+    }
 
-        if (abs(fc) < tolerancia || diferenca_final < tolerancia) {
-            iteracoes_realizadas = i + 1;
-            return c;
+    const vector<string> nomes_metodos = {"Newton", "Secante", "Regula Falsi", "Bissecao"};
+    const vector<string> nomes_registro = {"Newton", "Secante", "Falsa Posição", "Bisecção"};
+    const vector<string> nomes_aviso = {"Newton", "Secante", "Regula Falsi", "Bisseção"};
+    const size_t total_metodos = nomes_metodos.size();
+
+    vector<ResultadoCorrida> resultados(total_metodos);
+    atomic<bool> cancelado(false);
+    mutex mutex_corrida;
+    condition_variable aviso_corrida;
+    int vencedor = -1;
+    size_t terminados = 0;
+
+    // Cada metodo tem memo proprio, mas o orcamento e um so: o contador atomico de avaliacoes e o
+    // prazo sao compartilhados, entao MAX_AVALIACOES nunca e ultrapassado e o metodo mais rapido
+    // pode gastar o que os outros nao usaram.
+    shared_ptr<OrcamentoAvaliacoes> orcamento = criar_orcamento(max_avaliacoes, tempo_limite, chrono::steady_clock::now());
+
+    auto executar_metodo = [&](size_t indice) {
+        ResultadoCorrida resultado;
+        try {
+            function<double(double)> funcao_memorizada = funcao_f;
+            function<double(double)> funcao_df_metodo = funcao_df;
+            memorizar_avaliacoes(funcao_memorizada, funcao_df_metodo, orcamento);
+            // Cancelamento cooperativo: cada metodo pede f a cada iteracao, entao basta checar a flag ali.
+            // A checagem fica acima do memo para que um metodo ciclando entre pontos ja avaliados
+            // (so acertos no cache) tambem perceba o cancelamento.
+            function<double(double)> funcao_metodo = [&funcao_memorizada, &cancelado](double x) {
+                if (cancelado.load(memory_order_relaxed)) throw SolverCancelado();
+                return funcao_memorizada(x);
+            };
+
+            EstadoSolver estado;
+            if (indice == 0) {
+                estado = iniciar_newton((a_val + b_val) / 2, tolerancia, max_iteracoes);
+            } else if (indice == 1) {
+                estado = iniciar_secante(a_val, b_val, tolerancia, max_iteracoes);
+            } else if (indice == 2) {
+                estado = iniciar_falsa_posicao(a_val, b_val, tolerancia, max_iteracoes);
+            } else {
+                estado = iniciar_bissecao(a_val, b_val, tolerancia, max_iteracoes);
+            }
+            resultado.raiz = executar_solver(estado, nomes_registro[indice], nomes_aviso[indice], funcao_metodo, funcao_df_metodo, resultado.iteracoes, resultado.diferenca, resultado.residuo);
+            // Parar por orcamento ou por max_iteracoes nao conta como convergencia.
+            resultado.convergiu = (estado.situacao == SOLVER_CONVERGIU);
+            resultado.concluido = true;
+        } catch (const exception& e) {
+            resultado.erro = e.what();
         }
-        
-        c_anterior = c;
 
-        if (fc * fa < 0) {
-            b = c;
-            fb = fc;
-        } else {
-            a = c;
-            fa = fc;
+        lock_guard<mutex> trava(mutex_corrida);
+        resultados[indice] = resultado;
+        if (resultado.convergiu && vencedor < 0) {
+            vencedor = static_cast<int>(indice);
+            cancelado.store(true, memory_order_relaxed);
         }
+        terminados++;
+        aviso_corrida.notify_one();
+    };
+
+    vector<thread> threads;
+    for (size_t i = 0; i < total_metodos; ++i) {
+        threads.emplace_back(executar_metodo, i);
     }
 
-    iteracoes_realizadas = max_iteracoes;
-    diferenca_final = abs(c - c_anterior);
-    
-    cerr << "Aviso (Regula Falsi): Convergência não alcançada em " << max_iteracoes 
-         << " iterações. Erro atual: " << setprecision(10) << abs(fc) << endl;
-         
-    return c;
-}
+    {
+        unique_lock<mutex> trava(mutex_corrida);
+        aviso_corrida.wait(trava, [&] { return vencedor >= 0 || terminados == total_metodos; });
+    }
+    cancelado.store(true, memory_order_relaxed);
+    for (auto& t : threads) t.join();
+
+    int escolhido = vencedor;
+    if (escolhido < 0) {
+        // Nenhum convergiu: fica com o menor |f(raiz)| entre os que terminaram sem erro.
+        for (size_t i = 0; i < total_metodos; ++i) {
+            if (resultados[i].concluido && (escolhido < 0 || resultados[i].residuo < resultados[escolhido].residuo)) {
+                escolhido = static_cast<int>(i);
+            }
+        }
+    }
+    if (escolhido < 0) {
+        string erros;
+        for (size_t i = 0; i < total_metodos; ++i) {
+            erros += "\n  " + nomes_metodos[i] + ": " + resultados[i].erro;
+        }
+        throw runtime_error("Erro (Auto): Nenhum metodo encontrou uma raiz." + erros);
+    }
+
+    if (vencedor < 0) {
+        cerr << "Aviso (Auto): Nenhum metodo convergiu dentro de " << max_iteracoes
+             << " iterações e do orçamento. Usando " << nomes_metodos[escolhido] << ", erro atual: " << setprecision(10) << resultados[escolhido].residuo << endl;
+    }
+
+    metodo_vencedor = nomes_metodos[escolhido];
+    iteracoes_realizadas = resultados[escolhido].iteracoes;
+    diferenca_final = resultados[escolhido].diferenca;
+    residuo_final = resultados[escolhido].residuo;
+    return resultados[escolhido].raiz;
+}
\ No newline at end of file
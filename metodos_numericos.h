@@ -0,0 +1,77 @@
+#ifndef METODOS_NUMERICOS_H
+#define METODOS_NUMERICOS_H
+
+#include <string>
+#include <functional>
+
+const int METODO_BISSECAO = 0;
+const int METODO_PONTO_FIXO = 1;
+const int METODO_NEWTON = 2;
+const int METODO_SECANTE = 3;
+const int METODO_FALSA_POSICAO = 4;
+
+const int SOLVER_EM_ANDAMENTO = 0;
+const int SOLVER_CONVERGIU = 1;
+const int SOLVER_ESGOTADO = 2;
+const int SOLVER_FALHOU = 3;      // motivo em EstadoSolver::erro
+
+// Qual funcao o estado precisa avaliar em x_pendente; a auxiliar e g(x) no MIL e df(x) no Newton.
+const int AVALIAR_F = 0;
+const int AVALIAR_AUXILIAR = 1;
+
+const int FASE_INICIO_A = 0;
+const int FASE_INICIO_B = 1;
+const int FASE_AUXILIAR = 2;
+const int FASE_NOVO_PONTO = 3;
+
+// Estado completo de uma resolucao em andamento; pode ser copiado, guardado e retomado.
+// Erros do metodo (intervalo sem troca de sinal, derivada nula, ...) nao lancam excecao:
+// o estado passa a SOLVER_FALHOU com a mensagem em 'erro'.
+struct EstadoSolver {
+    int metodo = METODO_BISSECAO;
+    int situacao = SOLVER_EM_ANDAMENTO;
+    int fase = FASE_INICIO_A;
+    int avaliacao_pendente = AVALIAR_F;
+    double x_pendente = 0.0;
+    double a = 0.0, b = 0.0;             // intervalo (Bissecao e Regula Falsi)
+    double fa = 0.0, fb = 0.0;
+    double x = 0.0, fx = 0.0;            // iterado atual
+    double x_anterior = 0.0, fx_anterior = 0.0;
+    double diferenca = 0.0;
+    double tolerancia = 0.0;
+    int iteracao = 0;
+    int max_iteracoes = 0;
+    std::string erro;
+};
+
+// Cada metodo e uma maquina de estados: o estado pede uma avaliacao (x_pendente em f ou na
+// funcao auxiliar) e fornecer_avaliacao consome o valor. Um escalonador pode juntar os pedidos
+// de varios EstadoSolver, avaliar em lote e devolver os valores, intercalando milhares de resolucoes.
+// fornecer_avaliacao devolve true quando fecha uma iteracao; passo_solver roda uma iteracao inteira.
+EstadoSolver iniciar_bissecao(double a_val, double b_val, double tolerancia, int max_iteracoes);
+EstadoSolver iniciar_ponto_fixo(double x0_val, double tolerancia, int max_iteracoes);
+EstadoSolver iniciar_newton(double x0_val, double tolerancia, int max_iteracoes);
+EstadoSolver iniciar_secante(double x0_val, double x1_val, double tolerancia, int max_iteracoes);
+EstadoSolver iniciar_falsa_posicao(double a_val, double b_val, double tolerancia, int max_iteracoes);
+bool fornecer_avaliacao(EstadoSolver& estado, double valor);
+bool passo_solver(EstadoSolver& estado, const std::function<double(double)>& funcao_f, const std::function<double(double)>& funcao_auxiliar);
+double executar_solver(EstadoSolver& estado, const std::string& nome_registro, const std::string& nome_aviso, const std::function<double(double)>& funcao_f, const std::function<double(double)>& funcao_auxiliar, int& iteracoes_realizadas, double& diferenca_final, double& residuo_final);
+
+void memorizar_avaliacoes(std::function<double(double)>& funcao_f, std::function<double(double)>& funcao_auxiliar, int max_avaliacoes, double tempo_limite);
+void memorizar_avaliacoes(std::function<double(double)>& funcao_f, int max_avaliacoes, double tempo_limite);
+
+void registrarResultado(const std::string& nome_metodo, double raiz, double valor_funcao, double erro, int iteracoes);
+
+double bissecao(const std::function<double(double)>& funcao, double a_val, double b_val, double tolerancia, int max_iteracoes, int& iteracoes_realizadas, double& diferenca_final, double& residuo_final);
+
+double iteracao_ponto_fixo(const std::function<double(double)>& funcao_f, const std::function<double(double)>& funcao_g, double x0_val, double tolerancia, int max_iteracoes, int& iteracoes_realizadas, double& diferenca_final, double& residuo_final);
+
+double newton(const std::function<double(double)>& funcao_f, const std::function<double(double)>& funcao_df, double x0_val, double tolerancia, int max_iteracoes, int& iteracoes_realizadas, double& diferenca_final, double& residuo_final);
+
+double secante(const std::function<double(double)>& funcao, double x0_val, double x1_val, double tolerancia, int max_iteracoes, int& iteracoes_realizadas, double& diferenca_final, double& residuo_final);
+
+double falsa_posicao(const std::function<double(double)>& funcao, double a_val, double b_val, double tolerancia, int max_iteracoes, int& iteracoes_realizadas, double& diferenca_final, double& residuo_final);
+
+double metodo_automatico(const std::function<double(double)>& funcao_f, const std::function<double(double)>& funcao_df, double a_val, double b_val, double tolerancia, int max_iteracoes, int max_avaliacoes, double tempo_limite, int& iteracoes_realizadas, double& diferenca_final, double& residuo_final, std::string& metodo_vencedor);
+
+#endif